@@ -0,0 +1,129 @@
+// Binary data logger using BinaryRecord with a RingBuf.
+//
+// Each record is a timestamp and three ADC channels.  The timestamp
+// and channels are delta coded, so a record is usually 5 to 8 bytes
+// against about 25 bytes for the same line printed as CSV.  Decode the
+// file on a computer with extras/host/record_decode:
+//
+//   record_decode BinLogger.bin > BinLogger.csv
+
+#include "SdFat.h"
+#include "RingBuf.h"
+#include "BinaryRecord.h"
+
+// Use Teensy SDIO
+#define SD_CONFIG  SdioConfig(FIFO_SDIO)
+
+// Interval between records for 5 ksps.
+#define LOG_INTERVAL_USEC 200
+
+// Size to log at 5 kHz for more than ten minutes.
+#define LOG_FILE_SIZE 10*5000*600  // 30,000,000 bytes.
+
+// Space to hold more than 800 ms of records.
+#define RING_BUF_CAPACITY 80*512
+#define LOG_FILENAME "BinLogger.bin"
+
+SdFs sd;
+FsFile file;
+
+// RingBuf for File type FsFile.
+RingBuf<FsFile, RING_BUF_CAPACITY> rb;
+
+// The schema: field types and encodings.  The names go in the header.
+BinaryRecord<RingBuf<FsFile, RING_BUF_CAPACITY>,
+             BinaryField<uint32_t, BINARY_DELTA>,
+             BinaryField<uint16_t, BINARY_DELTA>,
+             BinaryField<uint16_t, BINARY_DELTA>,
+             BinaryField<uint16_t, BINARY_DELTA>> rec;
+
+void logData() {
+  // Initialize the SD.
+  if (!sd.begin(SD_CONFIG)) {
+    sd.initErrorHalt(&Serial);
+  }
+  // Open or create file - truncate existing file.
+  if (!file.open(LOG_FILENAME, O_RDWR | O_CREAT | O_TRUNC)) {
+    Serial.println("open failed\n");
+    return;
+  }
+  // File must be pre-allocated to avoid huge
+  // delays searching for free clusters.
+  if (!file.preAllocate(LOG_FILE_SIZE)) {
+     Serial.println("preAllocate failed\n");
+     file.close();
+     return;
+  }
+  // initialize the RingBuf and write the header.
+  rb.begin(&file);
+  rec.begin(&rb);
+  rec.writeHeader("micros,adc0,adc1,adc2");
+  Serial.println("Type any character to stop");
+
+  // Records dropped because the RingBuf was full.
+  uint32_t overruns = 0;
+  uint32_t count = 0;
+
+  // Start time.
+  uint32_t logTime = micros();
+  // Log data until Serial input or file full.
+  while (!Serial.available()) {
+    // Amount of data in ringBuf.
+    size_t n = rb.bytesUsed();
+    if ((n + file.curPosition()) > (LOG_FILE_SIZE - rec.MAX_SIZE)) {
+      Serial.println("File full - quiting.");
+      break;
+    }
+    if (n >= 512 && !file.isBusy()) {
+      // Write one sector from RingBuf to file.
+      if (512 != rb.writeOut(512)) {
+        Serial.println("writeOut failed");
+        break;
+      }
+    }
+    // Wait until time to log data.
+    logTime += LOG_INTERVAL_USEC;
+    while ((int32_t)(logTime - micros()) > 0) {}
+
+    uint32_t m = micros();
+    uint16_t adc0 = analogRead(0);
+    uint16_t adc1 = analogRead(1);
+    uint16_t adc2 = analogRead(2);
+    // RingBuf copies as much as fits, so only write whole records.
+    if (rb.bytesFree() < rec.MAX_SIZE) {
+      overruns++;
+      continue;
+    }
+    rec.write(m, adc0, adc1, adc2);
+    count++;
+  }
+  // Write any RingBuf data to file.
+  rb.sync();
+  file.truncate();
+  Serial.print("records: ");
+  Serial.println(count);
+  Serial.print("overruns: ");
+  Serial.println(overruns);
+  Serial.print("fileSize: ");
+  Serial.println((uint32_t)file.fileSize());
+  file.close();
+}
+void clearSerialInput() {
+  for (uint32_t m = micros(); micros() - m < 10000;) {
+    if (Serial.read() >= 0) {
+      m = micros();
+    }
+  }
+}
+void setup() {
+  Serial.begin(9600);
+  while (!Serial) {}
+}
+
+void loop() {
+  clearSerialInput();
+  Serial.println("Type any character to start");
+  while (!Serial.available()) {};
+  clearSerialInput();
+  logData();
+}
@@ -0,0 +1,117 @@
+// Binary ADC logger using RingBufSpsc with an interrupt producer.
+//
+// An IntervalTimer ISR stores each sample directly in the ring with
+// acquireWrite() and commit().  loop() writes whole sectors to the file
+// straight from the ring with writeSectorsOut().  Interrupts are never
+// disabled so the sample timing has no jitter from the ring buffer.
+
+#include "SdFat.h"
+#include "RingBufSpsc.h"
+
+// Use Teensy SDIO
+#define SD_CONFIG  SdioConfig(FIFO_SDIO)
+
+// Interval between samples for 25 ksps.
+#define LOG_INTERVAL_USEC 40
+
+// Size to log 2 byte samples at 25 kHz for ten minutes.
+#define LOG_FILE_SIZE 2*25000*600  // 30,000,000 bytes.
+
+// Space for over two seconds of samples.  Must be a power of two.
+#define RING_BUF_CAPACITY 256*512
+#define LOG_FILENAME "SpscLogger.bin"
+
+SdFs sd;
+FsFile file;
+
+RingBufSpsc<FsFile, RING_BUF_CAPACITY> rb;
+
+IntervalTimer timer;
+
+// Samples lost because the ring was full.
+volatile uint32_t overruns = 0;
+
+void sampleIsr() {
+  // Two bytes divide the capacity so acquireWrite() only fails if full.
+  uint16_t* p = reinterpret_cast<uint16_t*>(rb.acquireWrite(2));
+  if (!p) {
+    overruns++;
+    return;
+  }
+  *p = analogRead(0);
+  rb.commit(2);
+}
+
+void logData() {
+  // Initialize the SD.
+  if (!sd.begin(SD_CONFIG)) {
+    sd.initErrorHalt(&Serial);
+  }
+  // Open or create file - truncate existing file.
+  if (!file.open(LOG_FILENAME, O_RDWR | O_CREAT | O_TRUNC)) {
+    Serial.println("open failed\n");
+    return;
+  }
+  // File must be pre-allocated to avoid huge
+  // delays searching for free clusters.
+  if (!file.preAllocate(LOG_FILE_SIZE)) {
+     Serial.println("preAllocate failed\n");
+     file.close();
+     return;
+  }
+  rb.begin(&file);
+  overruns = 0;
+  Serial.println("Type any character to stop");
+
+  // Max RingBufSpsc used bytes. Useful to understand overrun.
+  size_t maxUsed = 0;
+
+  timer.begin(sampleIsr, LOG_INTERVAL_USEC);
+  while (!Serial.available()) {
+    size_t n = rb.bytesUsed();
+    if ((n + file.curPosition()) > (LOG_FILE_SIZE - 512)) {
+      Serial.println("File full - quiting.");
+      break;
+    }
+    if (n > maxUsed) {
+      maxUsed = n;
+    }
+    if (n >= 512 && !file.isBusy()) {
+      // Not busy only allows one sector before possible busy wait.
+      if (rb.writeSectorsOut(1) != 1) {
+        Serial.println("writeSectorsOut failed");
+        break;
+      }
+    }
+  }
+  timer.end();
+  // Write any RingBufSpsc data to file.
+  rb.sync();
+  file.truncate();
+  Serial.print("fileSize: ");
+  Serial.println((uint32_t)file.fileSize());
+  Serial.print("maxBytesUsed: ");
+  Serial.println(maxUsed);
+  Serial.print("overruns: ");
+  Serial.println(overruns);
+  file.close();
+}
+void clearSerialInput() {
+  for (uint32_t m = micros(); micros() - m < 10000;) {
+    if (Serial.read() >= 0) {
+      m = micros();
+    }
+  }
+}
+void setup() {
+  Serial.begin(9600);
+  while (!Serial) {}
+}
+
+void loop() {
+  clearSerialInput();
+  Serial.println("Type any character to start");
+  while (!Serial.available()) {};
+  clearSerialInput();
+  logData();
+}
@@ -0,0 +1,39 @@
+// Minimal Arduino environment for the host programs: the Print base class
+// and interrupt calls that RingBuf.h and RingBufSpsc.h need.
+
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+class __FlashStringHelper;
+
+// RingBuf only; the RingBufSpsc threads must not need them
+static inline void interrupts(void) { }
+static inline void noInterrupts(void) { }
+
+class Print
+{
+public:
+	Print() : writeError(0) { }
+	virtual ~Print() { }
+	virtual size_t write(uint8_t b) = 0;
+	virtual size_t write(const uint8_t *buf, size_t n) {
+		size_t i;
+		for (i=0; i < n; i++) {
+			if (!write(buf[i])) break;
+		}
+		return i;
+	}
+	size_t write(const char *s) { return write((const uint8_t *)s, strlen(s)); }
+	int getWriteError(void) { return writeError; }
+	void clearWriteError(void) { setWriteError(0); }
+protected:
+	void setWriteError(int err=1) { writeError = err; }
+private:
+	int writeError;
+};
+
+#endif // Arduino_h
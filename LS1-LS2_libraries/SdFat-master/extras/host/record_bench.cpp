@@ -0,0 +1,150 @@
+// BinaryRecord against BufferedPrint CSV for an IMU and pressure logger.
+//
+//   ./record_bench [records]
+//
+// Synthetic records, a microsecond timestamp, three accelerometer and
+// three gyro axes, pressure in pascals and a temperature, are encoded
+// into memory both ways.  The time per record and bytes per record are
+// printed; the host's times only show the ratio a logger would see.
+// The binary log goes to record_bench.bin and the CSV that record_decode
+// must produce from it to record_bench.csv, so
+//
+//   ./record_decode record_bench.bin | cmp - record_bench.csv
+//
+// checks the whole round trip.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+class __FlashStringHelper;
+#include "BufferedPrint.h"
+#include "BinaryRecord.h"
+
+#define NAMES "micros,ax,ay,az,gx,gy,gz,pressure,temp"
+
+struct Sample {
+	uint32_t micros;
+	int16_t acc[3];
+	int16_t gyro[3];
+	int32_t pressure;
+	float temp;
+};
+
+// grows to hold everything written
+class MemSink {
+public:
+	MemSink() : data(NULL), size(0), cap(0) { }
+	~MemSink() { free(data); }
+	size_t write(const uint8_t *src, size_t n) {
+		if (size + n > cap) {
+			cap = 2 * (size + n);
+			data = (uint8_t *)realloc(data, cap);
+			if (!data) return 0;
+		}
+		memcpy(data + size, src, n);
+		size += n;
+		return n;
+	}
+	uint8_t *data;
+	size_t size;
+	size_t cap;
+};
+
+typedef BinaryRecord<MemSink,
+	BinaryField<uint32_t, BINARY_DELTA>,
+	BinaryField<int16_t, BINARY_DELTA>,
+	BinaryField<int16_t, BINARY_DELTA>,
+	BinaryField<int16_t, BINARY_DELTA>,
+	BinaryField<int16_t>,
+	BinaryField<int16_t>,
+	BinaryField<int16_t>,
+	BinaryField<int32_t, BINARY_DELTA>,
+	BinaryField<float> > ImuRecord;
+
+static double seconds(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// a slow wander plus noise, like a logger at rest on the sea floor
+static void makeSamples(Sample *s, uint32_t n)
+{
+	srand(1);
+	uint32_t t = 0;
+	for (uint32_t i=0; i < n; i++) {
+		t += 1000 + rand() % 5;
+		s[i].micros = t;
+		for (int k=0; k < 3; k++) {
+			s[i].acc[k] = (k == 2 ? 16384 : 0) + (int)(i / 97) % 50 +
+				rand() % 41 - 20;
+			s[i].gyro[k] = rand() % 601 - 300;
+		}
+		s[i].pressure = 1013250 + (int32_t)(i / 13) % 200 + rand() % 7 - 3;
+		s[i].temp = 12.5f + (i % 1000) * 0.001f;
+	}
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t n = argc > 1 ? atoi(argv[1]) : 1000000;
+	Sample *s = (Sample *)malloc(n * sizeof(Sample));
+	if (!s) return 1;
+	makeSamples(s, n);
+
+	MemSink csv;
+	BufferedPrint<MemSink, 64> bp(&csv);
+	double t = seconds();
+	bp.printField(NAMES, '\n');
+	for (uint32_t i=0; i < n; i++) {
+		bp.printField(s[i].micros, ',');
+		for (int k=0; k < 3; k++) bp.printField(s[i].acc[k], ',');
+		for (int k=0; k < 3; k++) bp.printField(s[i].gyro[k], ',');
+		bp.printField(s[i].pressure, ',');
+		bp.printField(s[i].temp, '\n', 3);
+	}
+	bp.sync();
+	double tCsv = seconds() - t;
+
+	MemSink bin;
+	ImuRecord rec(&bin);
+	t = seconds();
+	rec.writeHeader(NAMES);
+	for (uint32_t i=0; i < n; i++) {
+		if (!rec.write(s[i].micros, s[i].acc[0], s[i].acc[1], s[i].acc[2],
+			s[i].gyro[0], s[i].gyro[1], s[i].gyro[2], s[i].pressure,
+			s[i].temp)) {
+			printf("write failed\n");
+			return 1;
+		}
+	}
+	double tBin = seconds() - t;
+
+	printf("%u records\n", n);
+	printf("BufferedPrint CSV  %6.1f ns/record %6.2f bytes/record\n",
+		1e9 * tCsv / n, (double)csv.size / n);
+	printf("BinaryRecord       %6.1f ns/record %6.2f bytes/record"
+		" (%zu at most, %zu raw)\n", 1e9 * tBin / n, (double)bin.size / n,
+		ImuRecord::MAX_SIZE, sizeof(uint32_t) + 6 * sizeof(int16_t) +
+		sizeof(int32_t) + sizeof(float));
+
+	FILE *fp = fopen("record_bench.bin", "wb");
+	if (!fp || fwrite(bin.data, 1, bin.size, fp) != bin.size || fclose(fp)) {
+		printf("can not write record_bench.bin\n");
+		return 1;
+	}
+	// what record_decode prints
+	fp = fopen("record_bench.csv", "w");
+	if (!fp) return 1;
+	fprintf(fp, "%s\n", NAMES);
+	for (uint32_t i=0; i < n; i++) {
+		fprintf(fp, "%u,%d,%d,%d,%d,%d,%d,%d,%.9g\n", s[i].micros,
+			s[i].acc[0], s[i].acc[1], s[i].acc[2], s[i].gyro[0],
+			s[i].gyro[1], s[i].gyro[2], s[i].pressure, s[i].temp);
+	}
+	fclose(fp);
+	free(s);
+	return 0;
+}